@@ -1,253 +1,626 @@
-#include "MATRIXES.h"
-#include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
-#include <assert.h>
-#include <string.h>
-
-//  c
-struct matrix {
-    double* data;   //  
-    size_t w;       //  ( )
-    size_t h;       //  ( )
-};
-
-//      
-matrix* matrix_alloc(size_t w, size_t h) {
-    matrix* m = malloc(sizeof(matrix));
-    if (!m) return NULL;  //    
-
-    //       
-    m->data = calloc(w * h, sizeof(double));
-    if (!m->data) {
-        free(m);  //    
-        return NULL;
-    }
-
-    m->w = w;  //  
-    m->h = h;  //  
-    return m;
-}
-
-//  ,  
-void matrix_free(matrix* m) {
-    if (m) {
-        free(m->data);  //  
-        free(m);        //  
-    }
-}
-
-//   
-matrix* matrix_copy(const matrix* m) {
-    if (!m) return NULL;  //   
-
-    matrix* copy = matrix_alloc(m->w, m->h);
-    if (!copy) return NULL;  //   
-
-    //  
-    memcpy(copy->data, m->data, m->w * m->h * sizeof(double));
-    return copy;
-}
-
-//     
-double* matrix_ptr(matrix* m, size_t i, size_t j) {
-    return &m->data[i * m->w + j];  //   
-}
-
-//      
-const double* matrix_cptr(const matrix* m, size_t i, size_t j) {
-    return &m->data[i * m->w + j];  //   
-}
-
-//   
-void matrix_set_zero(matrix* m) {
-    if (!m) return;
-    memset(m->data, 0, m->w * m->h * sizeof(double));  //  
-}
-
-//    
-void matrix_set_id(matrix* m) {
-    if (!m) return;
-    matrix_set_zero(m);  //   
-
-    //    (  )
-    size_t min_dim = m->w < m->h ? m->w : m->h;
-
-    //   
-    for (size_t i = 0; i < min_dim; ++i) {
-        *matrix_ptr(m, i, i) = 1.0;
-    }
-}
-
-//   
-matrix* matrix_alloc_zero(size_t w, size_t h) {
-    matrix* m = matrix_alloc(w, h);
-    if (m) matrix_set_zero(m);  //  
-    return m;
-}
-
-//   
-matrix* matrix_alloc_id(size_t w, size_t h) {
-    matrix* m = matrix_alloc(w, h);
-    if (m) matrix_set_id(m);  //   
-    return m;
-}
-
-//   ( )
-int matrix_assign(matrix* m1, const matrix* m2) {
-    //   
-    if (!m1 || !m2 || m1->w != m2->w || m1->h != m2->h)
-        return -1;  // :  
-
-    //  
-    memcpy(m1->data, m2->data, m1->w * m1->h * sizeof(double));
-    return 0;  //  
-}
-
-//  
-void matrix_transpose(matrix* m) {
-    if (!m) return;  //   
-
-    //      
-    if (m->w == m->h) {
-        for (size_t i = 0; i < m->h; ++i) {
-            for (size_t j = i + 1; j < m->w; ++j) {
-                //  
-                double tmp = *matrix_ptr(m, i, j);
-                *matrix_ptr(m, i, j) = *matrix_ptr(m, j, i);
-                *matrix_ptr(m, j, i) = tmp;
-            }
-        }
-    } else {
-        //      
-        matrix* temp = matrix_copy(m);
-        if (!temp) return;  //   
-
-        //       
-        free(m->data);
-        m->data = malloc(m->w * m->h * sizeof(double));
-        if (!m->data) {
-            //   
-            m->data = temp->data;
-            temp->data = NULL;
-            matrix_free(temp);
-            return;
-        }
-
-        //   
-        size_t old_w = m->w;
-        size_t old_h = m->h;
-
-        //   
-        m->w = old_h;
-        m->h = old_w;
-
-        //    
-        for (size_t i = 0; i < m->h; ++i) {
-            for (size_t j = 0; j < m->w; ++j) {
-                *matrix_ptr(m, i, j) = *matrix_cptr(temp, j, i);
-            }
-        }
-
-        matrix_free(temp);  //   
-    }
-}
-
-//   
-void matrix_swap_rows(matrix* m, size_t i1, size_t i2) {
-    //   
-    if (!m || i1 >= m->h || i2 >= m->h) return;
-
-    //   
-    for (size_t j = 0; j < m->w; ++j) {
-        double tmp = *matrix_ptr(m, i1, j);
-        *matrix_ptr(m, i1, j) = *matrix_ptr(m, i2, j);
-        *matrix_ptr(m, i2, j) = tmp;
-    }
-}
-
-//   
-void matrix_swap_cols(matrix* m, size_t j1, size_t j2) {
-    //   
-    if (!m || j1 >= m->w || j2 >= m->w) return;
-
-    //   
-    for (size_t i = 0; i < m->h; ++i) {
-        double tmp = *matrix_ptr(m, i, j1);
-        *matrix_ptr(m, i, j1) = *matrix_ptr(m, i, j2);
-        *matrix_ptr(m, i, j2) = tmp;
-    }
-}
-
-//    
-void matrix_mul_row(matrix* m, size_t i, double d) {
-    //   
-    if (!m || i >= m->h) return;
-
-    //    
-    for (size_t j = 0; j < m->w; ++j) {
-        *matrix_ptr(m, i, j) *= d;
-    }
-}
-
-//    
-void matrix_add_rows(matrix* m, size_t i1, size_t i2) {
-    //   
-    if (!m || i1 >= m->h || i2 >= m->h) return;
-
-    //   
-    for (size_t j = 0; j < m->w; ++j) {
-        *matrix_ptr(m, i1, j) += *matrix_ptr(m, i2, j);
-    }
-}
-
-//    (    )
-double matrix_norm(const matrix* m) {
-    //    
-    if (!m || m->w == 0 || m->h == 0) return 0.0;
-
-    double max_sum = 0.0;  //  
-    for (size_t i = 0; i < m->h; ++i) {
-        double row_sum = 0.0;  //   
-        for (size_t j = 0; j < m->w; ++j) {
-            row_sum += fabs(*matrix_cptr(m, i, j));  //  
-        }
-        //  
-        if (row_sum > max_sum) {
-            max_sum = row_sum;
-        }
-    }
-    return max_sum;
-}
-
-//  
-void matrix_print(const matrix* m) {
-    if (!m) {
-        printf("NULL matrix\n");
-        return;
-    }
-
-    //   
-    for (size_t i = 0; i < m->h; ++i) {
-        for (size_t j = 0; j < m->w; ++j) {
-            printf("%8.4f ", *matrix_cptr(m, i, j));  //  
-        }
-        printf("\n");  //    
-    }
-}
-
-//    
-matrix* matrix_input(size_t w, size_t h) {
-    matrix* m = matrix_alloc(w, h);
-    if (!m) return NULL;  //   
-
-    printf("Enter matrix %zux%zu:\n", h, w);  //   
-    for (size_t i = 0; i < h; ++i) {
-        for (size_t j = 0; j < w; ++j) {
-            scanf("%lf", matrix_ptr(m, i, j));  //  
-        }
-    }
-
-    return m;
-}
-
+#include "MATRIXES.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <string.h>
+
+// Директивы OpenMP применяются только при сборке с -fopenmp
+#ifdef _OPENMP
+#define MATRIX_OMP(...) _Pragma(#__VA_ARGS__)
+#else
+#define MATRIX_OMP(...)
+#endif
+
+#define MATRIX_PAR_MIN 16384   // Минимальное число элементов для распараллеливания
+#define MATRIX_ROW_BLOCK 256   // Строк в блоке при вычислении 1-нормы
+#define MATRIX_ROW_BLOCKS_MAX 64  // Наибольшее число блоков строк (память nrb*w)
+#define MATRIX_SUM_BLOCK 1024  // Размер блока редукций по всем элементам
+
+// Режим воспроизводимых результатов (см. matrix_set_reproducible)
+static int reproducible = 0;
+
+// вариант c
+struct matrix {
+    double* data;   // Данные матрицы
+    size_t w;       // Ширина (количество столбцов)
+    size_t h;       // Высота (количество строк)
+};
+
+// Выделение памяти под матрицу указанного размера
+matrix* matrix_alloc(size_t w, size_t h) {
+    matrix* m = malloc(sizeof(matrix));
+    if (!m) return NULL;  // Проверка успешности выделения памяти
+
+    // Выделение памяти под данные с инициализацией нулями
+    m->data = calloc(w * h, sizeof(double));
+    if (!m->data) {
+        free(m);  // Освобождение памяти при ошибке
+        return NULL;
+    }
+
+    m->w = w;  // Установка ширины
+    m->h = h;  // Установка высоты
+    return m;
+}
+
+// Освобождение памяти, занятой матрицей
+void matrix_free(matrix* m) {
+    if (m) {
+        free(m->data);  // Освобождение данных
+        free(m);        // Освобождение структуры
+    }
+}
+
+// Создание копии матрицы
+matrix* matrix_copy(const matrix* m) {
+    if (!m) return NULL;  // Проверка входного параметра
+
+    matrix* copy = matrix_alloc(m->w, m->h);
+    if (!copy) return NULL;  // Проверка успешности выделения
+
+    // Копирование данных
+    memcpy(copy->data, m->data, m->w * m->h * sizeof(double));
+    return copy;
+}
+
+// Получение указателя на элемент матрицы
+double* matrix_ptr(matrix* m, size_t i, size_t j) {
+    return &m->data[i * m->w + j];  // Вычисление позиции элемента
+}
+
+// Получение константного указателя на элемент матрицы
+const double* matrix_cptr(const matrix* m, size_t i, size_t j) {
+    return &m->data[i * m->w + j];  // Вычисление позиции элемента
+}
+
+// Заполнение матрицы нулями
+void matrix_set_zero(matrix* m) {
+    if (!m) return;
+    memset(m->data, 0, m->w * m->h * sizeof(double));  // Обнуление памяти
+}
+
+// Преобразование матрицы в единичную
+void matrix_set_id(matrix* m) {
+    if (!m) return;
+    matrix_set_zero(m);  // Сначала заполняем нулями
+
+    // Определяем минимальную размерность (для неквадратных матриц)
+    size_t min_dim = m->w < m->h ? m->w : m->h;
+
+    // Заполняем диагональ единицами
+    for (size_t i = 0; i < min_dim; ++i) {
+        *matrix_ptr(m, i, i) = 1.0;
+    }
+}
+
+// Создание нулевой матрицы
+matrix* matrix_alloc_zero(size_t w, size_t h) {
+    matrix* m = matrix_alloc(w, h);
+    if (m) matrix_set_zero(m);  // Инициализация нулями
+    return m;
+}
+
+// Создание единичной матрицы
+matrix* matrix_alloc_id(size_t w, size_t h) {
+    matrix* m = matrix_alloc(w, h);
+    if (m) matrix_set_id(m);  // Инициализация как единичной
+    return m;
+}
+
+// Присваивание матриц (копирование содержимого)
+int matrix_assign(matrix* m1, const matrix* m2) {
+    // Проверка совместимости размеров
+    if (!m1 || !m2 || m1->w != m2->w || m1->h != m2->h)
+        return -1;  // Ошибка: несовместимые размеры
+
+    // Копирование данных
+    memcpy(m1->data, m2->data, m1->w * m1->h * sizeof(double));
+    return 0;  // Успешное выполнение
+}
+
+// Транспонирование матрицы
+void matrix_transpose(matrix* m) {
+    if (!m) return;  // Проверка входного параметра
+
+    // Транспонирование на месте для квадратных матриц
+    if (m->w == m->h) {
+        for (size_t i = 0; i < m->h; ++i) {
+            for (size_t j = i + 1; j < m->w; ++j) {
+                // Обмен элементов
+                double tmp = *matrix_ptr(m, i, j);
+                *matrix_ptr(m, i, j) = *matrix_ptr(m, j, i);
+                *matrix_ptr(m, j, i) = tmp;
+            }
+        }
+    } else {
+        // Для неквадратных матриц создаем временную копию
+        matrix* temp = matrix_copy(m);
+        if (!temp) return;  // Проверка успешности копирования
+
+        // Освобождаем старые данные и выделяем новую память
+        free(m->data);
+        m->data = malloc(m->w * m->h * sizeof(double));
+        if (!m->data) {
+            // Восстановление при ошибке
+            m->data = temp->data;
+            temp->data = NULL;
+            matrix_free(temp);
+            return;
+        }
+
+        // Сохраняем старые размеры
+        size_t old_w = m->w;
+        size_t old_h = m->h;
+
+        // Меняем размеры местами
+        m->w = old_h;
+        m->h = old_w;
+
+        // Копируем данные с транспонированием
+        for (size_t i = 0; i < m->h; ++i) {
+            for (size_t j = 0; j < m->w; ++j) {
+                *matrix_ptr(m, i, j) = *matrix_cptr(temp, j, i);
+            }
+        }
+
+        matrix_free(temp);  // Освобождаем временную матрицу
+    }
+}
+
+// Перестановка строк матрицы
+void matrix_swap_rows(matrix* m, size_t i1, size_t i2) {
+    // Проверка корректности индексов
+    if (!m || i1 >= m->h || i2 >= m->h) return;
+
+    // Поэлементный обмен строк
+    for (size_t j = 0; j < m->w; ++j) {
+        double tmp = *matrix_ptr(m, i1, j);
+        *matrix_ptr(m, i1, j) = *matrix_ptr(m, i2, j);
+        *matrix_ptr(m, i2, j) = tmp;
+    }
+}
+
+// Перестановка столбцов матрицы
+void matrix_swap_cols(matrix* m, size_t j1, size_t j2) {
+    // Проверка корректности индексов
+    if (!m || j1 >= m->w || j2 >= m->w) return;
+
+    // Поэлементный обмен столбцов
+    for (size_t i = 0; i < m->h; ++i) {
+        double tmp = *matrix_ptr(m, i, j1);
+        *matrix_ptr(m, i, j1) = *matrix_ptr(m, i, j2);
+        *matrix_ptr(m, i, j2) = tmp;
+    }
+}
+
+// Умножение строки на скаляр
+void matrix_mul_row(matrix* m, size_t i, double d) {
+    // Проверка корректности индекса
+    if (!m || i >= m->h) return;
+
+    // Умножение каждого элемента строки
+    for (size_t j = 0; j < m->w; ++j) {
+        *matrix_ptr(m, i, j) *= d;
+    }
+}
+
+// Сложение двух строк матрицы
+void matrix_add_rows(matrix* m, size_t i1, size_t i2) {
+    // Проверка корректности индексов
+    if (!m || i1 >= m->h || i2 >= m->h) return;
+
+    // Почленное сложение строк
+    for (size_t j = 0; j < m->w; ++j) {
+        *matrix_ptr(m, i1, j) += *matrix_ptr(m, i2, j);
+    }
+}
+
+// Быстрые ядра редукций: четыре независимых аккумулятора позволяют
+// компилятору векторизовать цикл без -ffast-math и без OpenMP
+
+// Сумма модулей x[0..n)
+static double abs_sum4(const double* x, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        s0 += fabs(x[k]);
+        s1 += fabs(x[k + 1]);
+        s2 += fabs(x[k + 2]);
+        s3 += fabs(x[k + 3]);
+    }
+    for (; k < n; ++k) s0 += fabs(x[k]);
+    return (s0 + s1) + (s2 + s3);
+}
+
+// Максимальный модуль x[0..n). GCC не векторизует такой максимум без
+// -ffast-math, но четыре независимые цепочки сравнений не ждут друг друга
+static double abs_max4(const double* x, size_t n) {
+    double m0 = 0.0, m1 = 0.0, m2 = 0.0, m3 = 0.0;
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        double a0 = fabs(x[k]), a1 = fabs(x[k + 1]);
+        double a2 = fabs(x[k + 2]), a3 = fabs(x[k + 3]);
+        m0 = a0 > m0 ? a0 : m0;
+        m1 = a1 > m1 ? a1 : m1;
+        m2 = a2 > m2 ? a2 : m2;
+        m3 = a3 > m3 ? a3 : m3;
+    }
+    for (; k < n; ++k) {
+        double a = fabs(x[k]);
+        m0 = a > m0 ? a : m0;
+    }
+    m0 = m1 > m0 ? m1 : m0;
+    m2 = m3 > m2 ? m3 : m2;
+    return m2 > m0 ? m2 : m0;
+}
+
+// Сумма квадратов x[0..n) / scale
+static double sum_sq4(const double* x, size_t n, double scale) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        double t0 = x[k] / scale, t1 = x[k + 1] / scale;
+        double t2 = x[k + 2] / scale, t3 = x[k + 3] / scale;
+        s0 += t0 * t0;
+        s1 += t1 * t1;
+        s2 += t2 * t2;
+        s3 += t3 * t3;
+    }
+    for (; k < n; ++k) {
+        double t = x[k] / scale;
+        s0 += t * t;
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+// Скалярное произведение a[0..n) и b[0..n)
+static double dot4(const double* a, const double* b, size_t n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        s0 += a[k] * b[k];
+        s1 += a[k + 1] * b[k + 1];
+        s2 += a[k + 2] * b[k + 2];
+        s3 += a[k + 3] * b[k + 3];
+    }
+    for (; k < n; ++k) s0 += a[k] * b[k];
+    return (s0 + s1) + (s2 + s3);
+}
+
+// Включение/выключение режима воспроизводимых результатов
+void matrix_set_reproducible(int on) {
+    reproducible = on != 0;
+}
+
+// Текущий режим вычислений (1 - воспроизводимый)
+int matrix_get_reproducible(void) {
+    return reproducible;
+}
+
+// Вычисление нормы матрицы (максимальная сумма модулей элементов строки)
+double matrix_norm(const matrix* m) {
+    // Проверка на нулевой размер
+    if (!m || m->w == 0 || m->h == 0) return 0.0;
+
+    double max_sum = 0.0;  // Максимальная сумма
+    const size_t w = m->w;
+    const size_t h = m->h;
+    const double* data = m->data;
+
+    // Строки обрабатываются независимо, максимум не зависит от порядка
+    MATRIX_OMP(omp parallel for reduction(max:max_sum) if(w * h >= MATRIX_PAR_MIN))
+    for (size_t i = 0; i < h; ++i) {
+        double row_sum = abs_sum4(data + i * w, w);  // Сумма модулей элементов строки
+        // Обновление максимума
+        if (row_sum > max_sum) {
+            max_sum = row_sum;
+        }
+    }
+    return max_sum;
+}
+
+// 1-норма матрицы (максимальная сумма модулей элементов столбца)
+double matrix_norm_1(const matrix* m) {
+    if (!m || m->w == 0 || m->h == 0) return 0.0;
+
+    const size_t w = m->w;
+    const size_t h = m->h;
+    const double* data = m->data;
+
+    // Строки делятся на фиксированное (не зависящее от числа потоков) число
+    // блоков; в каждом блоке суммы по столбцам накапливаются построчно
+    // (непрерывный доступ к памяти), затем блоки складываются по порядку
+    size_t nrb = (h + MATRIX_ROW_BLOCK - 1) / MATRIX_ROW_BLOCK;
+    if (nrb > MATRIX_ROW_BLOCKS_MAX) nrb = MATRIX_ROW_BLOCKS_MAX;
+    const size_t rows = (h + nrb - 1) / nrb;  // Строк в блоке
+
+    double* col_sum = calloc(nrb * w, sizeof(double));
+    if (!col_sum) return -1.0;  // Ошибка выделения памяти
+
+    MATRIX_OMP(omp parallel for if(w * h >= MATRIX_PAR_MIN))
+    for (size_t b = 0; b < nrb; ++b) {
+        double* acc = col_sum + b * w;  // Суммы по столбцам для блока b
+        size_t i1 = (b + 1) * rows < h ? (b + 1) * rows : h;
+        for (size_t i = b * rows; i < i1; ++i) {
+            const double* row = data + i * w;
+            for (size_t j = 0; j < w; ++j) {
+                acc[j] += fabs(row[j]);
+            }
+        }
+    }
+
+    // Сложение блоков в фиксированном порядке
+    for (size_t b = 1; b < nrb; ++b) {
+        const double* acc = col_sum + b * w;
+        for (size_t j = 0; j < w; ++j) col_sum[j] += acc[j];
+    }
+
+    double max_sum = 0.0;
+    for (size_t j = 0; j < w; ++j) {
+        if (col_sum[j] > max_sum) max_sum = col_sum[j];
+    }
+    free(col_sum);
+    return max_sum;
+}
+
+// Максимальный модуль элемента матрицы
+double matrix_norm_max(const matrix* m) {
+    if (!m || m->w == 0 || m->h == 0) return 0.0;
+
+    const size_t n = m->w * m->h;
+    const double* data = m->data;
+
+    // Блоки по MATRIX_SUM_BLOCK; максимум не зависит от порядка
+    const size_t nb = (n + MATRIX_SUM_BLOCK - 1) / MATRIX_SUM_BLOCK;
+    double max_abs = 0.0;
+    MATRIX_OMP(omp parallel for reduction(max:max_abs) if(n >= MATRIX_PAR_MIN))
+    for (size_t b = 0; b < nb; ++b) {
+        size_t k1 = (b + 1) * MATRIX_SUM_BLOCK < n ? (b + 1) * MATRIX_SUM_BLOCK : n;
+        double a = abs_max4(data + b * MATRIX_SUM_BLOCK, k1 - b * MATRIX_SUM_BLOCK);
+        max_abs = a > max_abs ? a : max_abs;
+    }
+    return max_abs;
+}
+
+// Ядра с фиксированным порядком операций. Слияние умножения и сложения
+// в FMA (по умолчанию в GCC при -mfma / -march=native) меняет округление,
+// поэтому здесь оно запрещено: результат не зависит от набора инструкций.
+// MSVC в режиме /fp:precise FMA сам не формирует.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// Сумма квадратов элементов x[k0..k1) / scale строго по порядку
+static double block_sum_sq(const double* x, size_t k0, size_t k1, double scale) {
+    double s = 0.0;
+    for (size_t k = k0; k < k1; ++k) {
+        double t = x[k] / scale;
+        s += t * t;
+    }
+    return s;
+}
+
+// Скалярное произведение строго по порядку
+static double dot_fixed(const double* a, const double* b, size_t n) {
+    double s = 0.0;
+    for (size_t k = 0; k < n; ++k) s += a[k] * b[k];
+    return s;
+}
+
+// x = m^T * y (построчное накопление, порядок по строкам фиксирован)
+static void mul_vec_t_fixed(const double* data, size_t w, size_t h, const double* y, double* x) {
+    for (size_t j = 0; j < w; ++j) x[j] = 0.0;
+    for (size_t i = 0; i < h; ++i) {
+        const double* row = data + i * w;
+        const double yi = y[i];
+        for (size_t j = 0; j < w; ++j) x[j] += row[j] * yi;
+    }
+}
+
+// Евклидова норма вектора с масштабированием (без переполнения)
+static double vec_norm_2(const double* x, size_t n) {
+    double scale = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        double a = fabs(x[k]);
+        if (a > scale) scale = a;
+    }
+    if (scale == 0.0 || !isfinite(scale)) return scale;
+
+    double ssq = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        double t = x[k] / scale;
+        ssq += t * t;
+    }
+    return scale * sqrt(ssq);
+}
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT DEFAULT
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+// Сумма квадратов в фиксированном порядке: блоки по MATRIX_SUM_BLOCK
+// суммируются последовательно, а их частичные суммы складываются по
+// порядку блоков - результат не зависит от числа потоков и ширины SIMD
+static double sum_sq_fixed(const double* x, size_t n, double scale) {
+    const size_t nb = (n + MATRIX_SUM_BLOCK - 1) / MATRIX_SUM_BLOCK;
+    double s = 0.0;
+
+    double* part = malloc(nb * sizeof(double));  // Частичные суммы блоков
+    if (part) {
+        MATRIX_OMP(omp parallel for if(n >= MATRIX_PAR_MIN))
+        for (size_t b = 0; b < nb; ++b) {
+            size_t k1 = (b + 1) * MATRIX_SUM_BLOCK < n ? (b + 1) * MATRIX_SUM_BLOCK : n;
+            part[b] = block_sum_sq(x, b * MATRIX_SUM_BLOCK, k1, scale);
+        }
+        for (size_t b = 0; b < nb; ++b) s += part[b];
+        free(part);
+        return s;
+    }
+
+    // Без памяти под частичные суммы - тот же порядок в одном потоке
+    for (size_t b = 0; b < nb; ++b) {
+        size_t k1 = (b + 1) * MATRIX_SUM_BLOCK < n ? (b + 1) * MATRIX_SUM_BLOCK : n;
+        s += block_sum_sq(x, b * MATRIX_SUM_BLOCK, k1, scale);
+    }
+    return s;
+}
+
+// Норма Фробениуса: элементы масштабируются на максимальный модуль,
+// поэтому сумма квадратов не переполняется и не уходит в ноль
+double matrix_norm_fro(const matrix* m) {
+    if (!m || m->w == 0 || m->h == 0) return 0.0;
+
+    double scale = matrix_norm_max(m);
+    if (scale == 0.0 || !isfinite(scale)) return scale;  // Нулевая матрица, inf или nan
+
+    const size_t n = m->w * m->h;
+    const double* data = m->data;
+
+    if (reproducible) return scale * sqrt(sum_sq_fixed(data, n, scale));
+
+    const size_t nb = (n + MATRIX_SUM_BLOCK - 1) / MATRIX_SUM_BLOCK;
+    double ssq = 0.0;  // Сумма квадратов масштабированных элементов
+    MATRIX_OMP(omp parallel for reduction(+:ssq) if(n >= MATRIX_PAR_MIN))
+    for (size_t b = 0; b < nb; ++b) {
+        size_t k1 = (b + 1) * MATRIX_SUM_BLOCK < n ? (b + 1) * MATRIX_SUM_BLOCK : n;
+        ssq += sum_sq4(data + b * MATRIX_SUM_BLOCK, k1 - b * MATRIX_SUM_BLOCK, scale);
+    }
+    return scale * sqrt(ssq);
+}
+
+// Скалярное произведение: в быстром режиме в четыре аккумулятора,
+// в воспроизводимом - строго по порядку
+static double dot(const double* a, const double* b, size_t n) {
+    if (reproducible) return dot_fixed(a, b, n);
+
+    return dot4(a, b, n);
+}
+
+// y = m * x для вектора x длины w
+static void matrix_mul_vec(const matrix* m, const double* x, double* y) {
+    const size_t w = m->w;
+    const size_t h = m->h;
+    const double* data = m->data;
+
+    MATRIX_OMP(omp parallel for if(w * h >= MATRIX_PAR_MIN))
+    for (size_t i = 0; i < h; ++i) {
+        y[i] = dot(data + i * w, x, w);
+    }
+}
+
+// Оценка 2-нормы (наибольшего сингулярного числа) степенным методом:
+// попеременное умножение на m и m^T с нормировкой на каждом шаге
+double matrix_norm_2(const matrix* m, double eps, size_t max_iter) {
+    if (!m || m->w == 0 || m->h == 0) return 0.0;
+
+    const size_t w = m->w;
+    const size_t h = m->h;
+    const double* data = m->data;
+
+    double* x = malloc(w * sizeof(double));  // Приближение правого сингулярного вектора
+    double* y = malloc(h * sizeof(double));  // Приближение левого сингулярного вектора
+    if (!x || !y) {
+        free(x);
+        free(y);
+        return -1.0;  // Ошибка выделения памяти
+    }
+
+    // Нулевая матрица - единственный случай нулевой нормы
+    if (matrix_norm_max(m) == 0.0) {
+        free(x);
+        free(y);
+        return 0.0;
+    }
+
+    // Начальное приближение: фиксированный псевдослучайный вектор
+    // (вектор из равных компонент ортогонален строкам, например, лапласиана)
+    unsigned long seed = 12345;
+    for (size_t j = 0; j < w; ++j) {
+        seed = (seed * 1103515245ul + 12345ul) & 0x7ffffffful;
+        double r = 0.5 + (double)(seed >> 8) / (double)(1ul << 23);  // [0.5, 1.5)
+        x[j] = (seed & 0x80) ? -r : r;
+    }
+    matrix_mul_vec(m, x, y);
+
+    // Если приближение все же попало в ядро, берем столбец с наибольшей
+    // суммой модулей: m * e_j - ненулевой столбец матрицы
+    if (vec_norm_2(y, h) == 0.0) {
+        size_t j_max = 0;
+        double best = -1.0;
+        for (size_t j = 0; j < w; ++j) {
+            double c = 0.0;
+            for (size_t i = 0; i < h; ++i) c += fabs(data[i * w + j]);
+            if (c > best) {
+                best = c;
+                j_max = j;
+            }
+        }
+        for (size_t j = 0; j < w; ++j) x[j] = 0.0;
+        x[j_max] = 1.0;
+    }
+
+    double sigma = 0.0;  // Текущая оценка нормы
+    for (size_t it = 0; it < max_iter || it == 0; ++it) {  // Хотя бы одна итерация
+        // y = m * x
+        matrix_mul_vec(m, x, y);
+
+        // y != 0: начальное x проверено выше, далее x лежит в пространстве строк
+        double yn = vec_norm_2(y, h);
+        if (yn == 0.0) break;  // Потеря значимости - оставляем последнюю оценку
+        for (size_t i = 0; i < h; ++i) y[i] /= yn;
+
+        // x = m^T * y
+        mul_vec_t_fixed(data, w, h, y, x);
+
+        // ||m^T * y|| при ||y|| = 1 монотонно сходится к sigma_max снизу
+        double sigma_new = vec_norm_2(x, w);
+        for (size_t j = 0; j < w; ++j) x[j] /= sigma_new;
+
+        // Проверка сходимости по относительному изменению оценки
+        int done = fabs(sigma_new - sigma) <= eps * sigma_new;
+        sigma = sigma_new;
+        if (done) break;
+    }
+
+    free(x);
+    free(y);
+    return sigma;
+}
+
+// Печать матрицы
+void matrix_print(const matrix* m) {
+    if (!m) {
+        printf("NULL matrix\n");
+        return;
+    }
+
+    // Построчный вывод элементов
+    for (size_t i = 0; i < m->h; ++i) {
+        for (size_t j = 0; j < m->w; ++j) {
+            printf("%8.4f ", *matrix_cptr(m, i, j));  // Форматированный вывод
+        }
+        printf("\n");  // Переход на новую строку
+    }
+}
+
+// Ввод матрицы с клавиатуры
+matrix* matrix_input(size_t w, size_t h) {
+    matrix* m = matrix_alloc(w, h);
+    if (!m) return NULL;  // Проверка успешности выделения
+
+    printf("Enter matrix %zux%zu:\n", h, w);  // Приглашение к вводу
+    for (size_t i = 0; i < h; ++i) {
+        for (size_t j = 0; j < w; ++j) {
+            scanf("%lf", matrix_ptr(m, i, j));  // Чтение элемента
+        }
+    }
+
+    return m;
+}
+
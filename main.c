@@ -1,68 +1,122 @@
-#include "MATRIXES.h"
-#include <stdio.h>
-#include "matrix_operations.h"
-#include "matrix_manipulations.h"
-
-int main() {
-    //   
-    printf("Testing matrix exponential:\n");
-    //    3x3
-    matrix* m = matrix_alloc(3, 3);
-    *matrix_ptr(m, 0, 0) = 1.0;  //  (0,0)
-    *matrix_ptr(m, 1, 1) = 2.0;  //  (1,1)
-    *matrix_ptr(m, 2, 2) = -1.0; //  (2,2)
-
-    printf("Input matrix:\n");
-    matrix_print(m);  //   
-
-    //      1e-10
-    matrix* exp_m = matrix_exp(m, 1e-10);
-    printf("Matrix exponential:\n");
-    matrix_print(exp_m);  //  
-
-    //  
-    matrix_free(m);
-    matrix_free(exp_m);
-
-    //   
-    printf("\nTesting Gauss method:\n");
-    //    A
-    matrix* A = matrix_alloc(3, 3);
-    *matrix_ptr(A, 0, 0) = 2.0; *matrix_ptr(A, 0, 1) = 1.0; *matrix_ptr(A, 0, 2) = -1.0;
-    *matrix_ptr(A, 1, 0) = -3.0; *matrix_ptr(A, 1, 1) = -1.0; *matrix_ptr(A, 1, 2) = 2.0;
-    *matrix_ptr(A, 2, 0) = -2.0; *matrix_ptr(A, 2, 1) = 1.0; *matrix_ptr(A, 2, 2) = 2.0;
-
-    //     B
-    matrix* B = matrix_alloc(1, 3);  // -
-    *matrix_ptr(B, 0, 0) = 8.0;     //  
-    *matrix_ptr(B, 1, 0) = -11.0;   //  
-    *matrix_ptr(B, 2, 0) = -3.0;    //  
-
-    printf("Matrix A:\n");
-    matrix_print(A);  //   A
-    printf("\nRight-hand side vector B:\n");
-    matrix_print(B);  //   B
-
-    //    AX = B
-    matrix* X = matrix_solve_gauss(A, B);
-    printf("\nSolution X:\n");
-    matrix_print(X);  //  
-
-    //  :   A*X - B
-    if (X) {
-        matrix* AX = matrix_alloc(1, 3);  //    A*X
-        matrix_mul2(AX, A, X);           //  A  X
-        matrix_sub(AX, B);                //  B (AX - B)
-        printf("Residual A*X - B (should be near zero):\n");
-        matrix_print(AX);                 //  
-        printf("Residual norm: %f\n", matrix_norm(AX));  //   
-        matrix_free(AX);                  //  
-    }
-
-    //  
-    matrix_free(A);
-    matrix_free(B);
-    matrix_free(X);
-
-    return 0;
-}
+#include "MATRIXES.h"
+#include <stdio.h>
+#include "matrix_operations.h"
+#include "matrix_manipulations.h"
+#include "matrix_tasks.h"
+
+int main() {
+    // Тестирование матричной экспоненты
+    printf("Testing matrix exponential:\n");
+    // Создание диагональной матрицы 3x3
+    matrix* m = matrix_alloc(3, 3);
+    *matrix_ptr(m, 0, 0) = 1.0;  // Элемент (0,0)
+    *matrix_ptr(m, 1, 1) = 2.0;  // Элемент (1,1)
+    *matrix_ptr(m, 2, 2) = -1.0; // Элемент (2,2)
+
+    printf("Input matrix:\n");
+    matrix_print(m);  // Печать исходной матрицы
+
+    // Вычисление матричной экспоненты с точностью 1e-10
+    matrix* exp_m = matrix_exp(m, 1e-10);
+    printf("Matrix exponential:\n");
+    matrix_print(exp_m);  // Печать результата
+
+    // Действие экспоненты на вектор без построения exp(t*m): exp(t*m)*v
+    matrix* v = matrix_alloc(1, 3);  // Вектор-столбец из единиц
+    for (size_t i = 0; i < 3; ++i) *matrix_ptr(v, i, 0) = 1.0;
+
+    double times[3] = {0.5, 1.0, 2.0};  // Точки времени
+    matrix* ev[3];
+    if (matrix_expm_multiply_times(m, v, times, 3, 1e-16, ev) == 0) {
+        for (size_t k = 0; k < 3; ++k) {
+            printf("exp(%.1f*m)*v:\n", times[k]);
+            matrix_print(ev[k]);
+            matrix_free(ev[k]);
+        }
+    }
+    matrix_free(v);
+
+    // Освобождение памяти
+    matrix_free(m);
+    matrix_free(exp_m);
+
+    // Тестирование метода Гаусса
+    printf("\nTesting Gauss method:\n");
+    // Создание матрицы коэффициентов A
+    matrix* A = matrix_alloc(3, 3);
+    *matrix_ptr(A, 0, 0) = 2.0; *matrix_ptr(A, 0, 1) = 1.0; *matrix_ptr(A, 0, 2) = -1.0;
+    *matrix_ptr(A, 1, 0) = -3.0; *matrix_ptr(A, 1, 1) = -1.0; *matrix_ptr(A, 1, 2) = 2.0;
+    *matrix_ptr(A, 2, 0) = -2.0; *matrix_ptr(A, 2, 1) = 1.0; *matrix_ptr(A, 2, 2) = 2.0;
+
+    // Создание вектора правых частей B
+    matrix* B = matrix_alloc(1, 3);  // Вектор-столбец
+    *matrix_ptr(B, 0, 0) = 8.0;     // Первый элемент
+    *matrix_ptr(B, 1, 0) = -11.0;   // Второй элемент
+    *matrix_ptr(B, 2, 0) = -3.0;    // Третий элемент
+
+    printf("Matrix A:\n");
+    matrix_print(A);  // Печать матрицы A
+    printf("\nRight-hand side vector B:\n");
+    matrix_print(B);  // Печать вектора B
+
+    // Решение системы уравнений AX = B
+    matrix* X = matrix_solve_gauss(A, B);
+    printf("\nSolution X:\n");
+    matrix_print(X);  // Печать решения
+
+    // Проверка решения: вычисление невязки A*X - B
+    if (X) {
+        matrix* AX = matrix_alloc(1, 3);  // Вектор для результата A*X
+        matrix_mul2(AX, A, X);           // Умножение A на X
+        matrix_sub(AX, B);                // Вычитание B (AX - B)
+        printf("Residual A*X - B (should be near zero):\n");
+        matrix_print(AX);                 // Печать невязки
+        printf("Residual norm: %f\n", matrix_norm(AX));  // Вычисление нормы невязки
+        matrix_free(AX);                  // Освобождение памяти
+    }
+
+    // Тестирование норм и оценки обусловленности
+    printf("\nTesting norms and condition estimate:\n");
+    printf("Norms of A: 1 = %f, inf = %f, max = %f, fro = %f, 2 = %f\n",
+           matrix_norm_1(A), matrix_norm(A), matrix_norm_max(A),
+           matrix_norm_fro(A), matrix_norm_2(A, 1e-12, 1000));
+
+    matrix_set_reproducible(1);         // Порядок суммирования не зависит от потоков
+    printf("Reproducible fro norm of A: %.17g\n", matrix_norm_fro(A));
+    matrix_set_reproducible(0);
+
+    size_t piv[3];                      // Перестановки строк LU-разложения
+    matrix* LU = matrix_lu(A, piv);     // LU-разложение матрицы A
+    printf("Condition number estimate of A: %f\n", matrix_cond_est(A, LU, piv));
+    matrix_free(LU);
+
+    // Тестирование асинхронного графа задач: AT = A^T, C = AT*A, E = C + A, E*Y = B
+    printf("\nTesting task graph:\n");
+    matrix_graph* g = matrix_graph_alloc(0);  // Пул по числу ядер
+    matrix* AT = matrix_copy(A);
+    matrix* C = matrix_alloc(3, 3);
+    matrix* E = matrix_alloc(3, 3);
+    matrix* Y = NULL;
+
+    matrix_task* t_tr = matrix_async_transpose(g, AT, NULL, 0);
+    matrix_task* t_mul = matrix_async_mul2(g, C, AT, A, &t_tr, 1);
+    matrix_task* t_add = matrix_async_add2(g, E, C, A, &t_mul, 1);
+    matrix_task* t_solve = matrix_async_solve_gauss(g, &Y, E, B, &t_add, 1);
+
+    if (matrix_task_wait(t_solve) == 0) {
+        printf("Solution of (A^T*A + A)*Y = B:\n");
+        matrix_print(Y);
+    }
+    matrix_graph_free(g);  // Ожидание всех задач и освобождение графа
+    matrix_free(AT);
+    matrix_free(C);
+    matrix_free(E);
+    matrix_free(Y);
+
+    // Освобождение памяти
+    matrix_free(A);
+    matrix_free(B);
+    matrix_free(X);
+
+    return 0;
+}
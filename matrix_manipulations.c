@@ -1,171 +1,529 @@
-#include "matrix_manipulations.h"
-#include "matrix_operations.h"
-#include <math.h>
-
-// вариант c
-struct matrix {
-    double* data;   // Данные матрицы
-    size_t w;       // Ширина (количество столбцов)
-    size_t h;       // Высота (количество строк)
-};
-
-// Вычисление матричной экспоненты exp(m)
-matrix* matrix_exp(const matrix* m, double eps) {
-    // Проверка входных параметров: матрица должна быть квадратной
-    if (!m || m->w != m->h) return NULL;
-
-    size_t n = m->w;
-    // Создание единичной матрицы (начальное приближение)
-    matrix* result = matrix_alloc_id(n, n);
-    if (!result) return NULL;
-
-    // Первый член ряда Тейлора
-    matrix* term = matrix_copy(m);
-    if (!term) {
-        matrix_free(result);
-        return NULL;
-    }
-
-    int k = 1;  // Счетчик итераций/факториал
-    // Итерации пока норма текущего члена больше epsilon
-    while (matrix_norm(term) >= eps) {
-        // Копирование текущего результата
-        matrix* temp = matrix_copy(result);
-        if (!temp) {
-            matrix_free(result);
-            matrix_free(term);
-            return NULL;
-        }
-
-        // Добавление текущего члена ряда к результату
-        if (matrix_add(temp, term) != 0) {
-            matrix_free(temp);
-            matrix_free(result);
-            matrix_free(term);
-            return NULL;
-        }
-
-        // Обновление результата
-        matrix_free(result);
-        result = temp;
-
-        // Вычисление следующего члена ряда: term = term * m / (k+1)
-        matrix* next_term = matrix_alloc(n, n);
-        if (!next_term) {
-            matrix_free(result);
-            matrix_free(term);
-            return NULL;
-        }
-
-        // Умножение текущего члена на исходную матрицу
-        if (matrix_mul2(next_term, term, m) != 0) {
-            matrix_free(next_term);
-            matrix_free(result);
-            matrix_free(term);
-            return NULL;
-        }
-
-        // Деление на следующий факториал
-        matrix_sdiv(next_term, ++k);
-
-        // Переход к следующему члену ряда
-        matrix_free(term);
-        term = next_term;
-    }
-
-    // Освобождение памяти последнего члена ряда
-    matrix_free(term);
-    return result;  // Возврат результата
-}
-
-// Решение СЛАУ методом Гаусса с выбором ведущего элемента
-matrix* matrix_solve_gauss(const matrix* A, const matrix* B) {
-    // Проверка входных параметров:
-    // - A должна быть квадратной
-    // - B должна быть вектором-столбцом
-    // - Размеры A и B должны быть согласованы
-    if (!A || !B || A->w != A->h || A->h != B->h || B->w != 1)
-        return NULL;
-
-    const size_t n = A->h;  // Размер системы
-
-    // Создание копий матриц, чтобы не изменять оригиналы
-    matrix* ACopy = matrix_copy(A);
-    matrix* BCopy = matrix_copy(B);
-    if (!ACopy || !BCopy) {
-        matrix_free(ACopy);
-        matrix_free(BCopy);
-        return NULL;
-    }
-
-    // Прямой ход метода Гаусса
-    for (size_t k = 0; k < n; ++k) {
-        // Поиск строки с максимальным элементом в текущем столбце
-        size_t max_row = k;
-        double max_val = fabs(*matrix_ptr(ACopy, k, k));
-
-        // Поиск максимума в столбце ниже текущей строки
-        for (size_t i = k + 1; i < n; ++i) {
-            double val = fabs(*matrix_ptr(ACopy, i, k));
-            if (val > max_val) {
-                max_val = val;
-                max_row = i;
-            }
-        }
-
-        // Перестановка строк, если найден больший элемент
-        if (max_row != k) {
-            matrix_swap_rows(ACopy, k, max_row);  // Перестановка в матрице A
-
-            // Перестановка соответствующих элементов в векторе B
-            double tmp = *matrix_ptr(BCopy, k, 0);
-            *matrix_ptr(BCopy, k, 0) = *matrix_ptr(BCopy, max_row, 0);
-            *matrix_ptr(BCopy, max_row, 0) = tmp;
-        }
-
-        // Проверка на вырожденность (нулевой диагональный элемент)
-        if (fabs(*matrix_ptr(ACopy, k, k)) < 1e-12) {
-            matrix_free(ACopy);
-            matrix_free(BCopy);
-            return NULL;  // Система вырождена
-        }
-
-        // Исключение элементов ниже диагонали
-        for (size_t i = k + 1; i < n; ++i) {
-            // Вычисление множителя для исключения
-            double factor = *matrix_ptr(ACopy, i, k) / *matrix_ptr(ACopy, k, k);
-
-            // Вычитание строки k из строки i в векторе B
-            *matrix_ptr(BCopy, i, 0) -= factor * *matrix_ptr(BCopy, k, 0);
-
-            // Вычитание строки k из строки i в матрице A
-            for (size_t j = k; j < n; ++j) {
-                *matrix_ptr(ACopy, i, j) -= factor * *matrix_ptr(ACopy, k, j);
-            }
-        }
-    }
-
-    // Обратный ход метода Гаусса
-    matrix* X = matrix_alloc(1, n);  // Вектор решений
-    if (!X) {
-        matrix_free(ACopy);
-        matrix_free(BCopy);
-        return NULL;
-    }
-
-    // Начиная с последней строки и двигаясь вверх
-    for (size_t i = n; i-- > 0; ) {
-        double sum = 0.0;
-        // Суммирование известных членов
-        for (size_t j = i + 1; j < n; ++j) {
-            sum += *matrix_ptr(ACopy, i, j) * *matrix_ptr(X, j, 0);
-        }
-        // Вычисление неизвестного
-        *matrix_ptr(X, i, 0) = (*matrix_ptr(BCopy, i, 0) - sum) / *matrix_ptr(ACopy, i, i);
-    }
-
-    // Освобождение временных матриц
-    matrix_free(ACopy);
-    matrix_free(BCopy);
-    return X;  // Возврат вектора решений
-}
+#include "matrix_manipulations.h"
+#include "matrix_operations.h"
+#include <math.h>
+#include <stdlib.h>
+
+// вариант c
+struct matrix {
+    double* data;   // Данные матрицы
+    size_t w;       // Ширина (количество столбцов)
+    size_t h;       // Высота (количество строк)
+};
+
+// Вычисление матричной экспоненты exp(m)
+matrix* matrix_exp(const matrix* m, double eps) {
+    // Проверка входных параметров: матрица должна быть квадратной
+    if (!m || m->w != m->h) return NULL;
+
+    size_t n = m->w;
+    // Создание единичной матрицы (начальное приближение)
+    matrix* result = matrix_alloc_id(n, n);
+    if (!result) return NULL;
+
+    // Первый член ряда Тейлора
+    matrix* term = matrix_copy(m);
+    if (!term) {
+        matrix_free(result);
+        return NULL;
+    }
+
+    int k = 1;  // Счетчик итераций/факториал
+    // Итерации пока норма текущего члена больше epsilon
+    while (matrix_norm(term) >= eps) {
+        // Копирование текущего результата
+        matrix* temp = matrix_copy(result);
+        if (!temp) {
+            matrix_free(result);
+            matrix_free(term);
+            return NULL;
+        }
+
+        // Добавление текущего члена ряда к результату
+        if (matrix_add(temp, term) != 0) {
+            matrix_free(temp);
+            matrix_free(result);
+            matrix_free(term);
+            return NULL;
+        }
+
+        // Обновление результата
+        matrix_free(result);
+        result = temp;
+
+        // Вычисление следующего члена ряда: term = term * m / (k+1)
+        matrix* next_term = matrix_alloc(n, n);
+        if (!next_term) {
+            matrix_free(result);
+            matrix_free(term);
+            return NULL;
+        }
+
+        // Умножение текущего члена на исходную матрицу
+        if (matrix_mul2(next_term, term, m) != 0) {
+            matrix_free(next_term);
+            matrix_free(result);
+            matrix_free(term);
+            return NULL;
+        }
+
+        // Деление на следующий факториал
+        matrix_sdiv(next_term, ++k);
+
+        // Переход к следующему члену ряда
+        matrix_free(term);
+        term = next_term;
+    }
+
+    // Освобождение памяти последнего члена ряда
+    matrix_free(term);
+    return result;  // Возврат результата
+}
+
+// Прямые методы решения СЛАУ и LU-разложение собираются без слияния
+// в FMA, чтобы их результат не зависел от набора инструкций
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// Решение СЛАУ методом Гаусса с выбором ведущего элемента
+matrix* matrix_solve_gauss(const matrix* A, const matrix* B) {
+    // Проверка входных параметров:
+    // - A должна быть квадратной
+    // - B должна быть вектором-столбцом
+    // - Размеры A и B должны быть согласованы
+    if (!A || !B || A->w != A->h || A->h != B->h || B->w != 1)
+        return NULL;
+
+    const size_t n = A->h;  // Размер системы
+
+    // Создание копий матриц, чтобы не изменять оригиналы
+    matrix* ACopy = matrix_copy(A);
+    matrix* BCopy = matrix_copy(B);
+    if (!ACopy || !BCopy) {
+        matrix_free(ACopy);
+        matrix_free(BCopy);
+        return NULL;
+    }
+
+    // Прямой ход метода Гаусса
+    for (size_t k = 0; k < n; ++k) {
+        // Поиск строки с максимальным элементом в текущем столбце
+        size_t max_row = k;
+        double max_val = fabs(*matrix_ptr(ACopy, k, k));
+
+        // Поиск максимума в столбце ниже текущей строки
+        for (size_t i = k + 1; i < n; ++i) {
+            double val = fabs(*matrix_ptr(ACopy, i, k));
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+
+        // Перестановка строк, если найден больший элемент
+        if (max_row != k) {
+            matrix_swap_rows(ACopy, k, max_row);  // Перестановка в матрице A
+
+            // Перестановка соответствующих элементов в векторе B
+            double tmp = *matrix_ptr(BCopy, k, 0);
+            *matrix_ptr(BCopy, k, 0) = *matrix_ptr(BCopy, max_row, 0);
+            *matrix_ptr(BCopy, max_row, 0) = tmp;
+        }
+
+        // Проверка на вырожденность (нулевой диагональный элемент)
+        if (fabs(*matrix_ptr(ACopy, k, k)) < 1e-12) {
+            matrix_free(ACopy);
+            matrix_free(BCopy);
+            return NULL;  // Система вырождена
+        }
+
+        // Исключение элементов ниже диагонали
+        for (size_t i = k + 1; i < n; ++i) {
+            // Вычисление множителя для исключения
+            double factor = *matrix_ptr(ACopy, i, k) / *matrix_ptr(ACopy, k, k);
+
+            // Вычитание строки k из строки i в векторе B
+            *matrix_ptr(BCopy, i, 0) -= factor * *matrix_ptr(BCopy, k, 0);
+
+            // Вычитание строки k из строки i в матрице A
+            for (size_t j = k; j < n; ++j) {
+                *matrix_ptr(ACopy, i, j) -= factor * *matrix_ptr(ACopy, k, j);
+            }
+        }
+    }
+
+    // Обратный ход метода Гаусса
+    matrix* X = matrix_alloc(1, n);  // Вектор решений
+    if (!X) {
+        matrix_free(ACopy);
+        matrix_free(BCopy);
+        return NULL;
+    }
+
+    // Начиная с последней строки и двигаясь вверх
+    for (size_t i = n; i-- > 0; ) {
+        double sum = 0.0;
+        // Суммирование известных членов
+        for (size_t j = i + 1; j < n; ++j) {
+            sum += *matrix_ptr(ACopy, i, j) * *matrix_ptr(X, j, 0);
+        }
+        // Вычисление неизвестного
+        *matrix_ptr(X, i, 0) = (*matrix_ptr(BCopy, i, 0) - sum) / *matrix_ptr(ACopy, i, i);
+    }
+
+    // Освобождение временных матриц
+    matrix_free(ACopy);
+    matrix_free(BCopy);
+    return X;  // Возврат вектора решений
+}
+
+// LU-разложение с частичным выбором ведущего элемента: P*A = L*U.
+// L (с единичной диагональю) и U хранятся в одной матрице,
+// piv[k] - номер строки, переставленной со строкой k на шаге k.
+// Нулевой ведущий элемент не прерывает разложение: вырожденность
+// обнаруживается при решении или при оценке обусловленности.
+matrix* matrix_lu(const matrix* A, size_t* piv) {
+    if (!A || !piv || A->w != A->h) return NULL;
+
+    const size_t n = A->h;
+    matrix* LU = matrix_copy(A);
+    if (!LU) return NULL;
+
+    for (size_t k = 0; k < n; ++k) {
+        // Поиск ведущего элемента в столбце k
+        size_t max_row = k;
+        double max_val = fabs(*matrix_ptr(LU, k, k));
+        for (size_t i = k + 1; i < n; ++i) {
+            double val = fabs(*matrix_ptr(LU, i, k));
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+
+        piv[k] = max_row;
+        if (max_row != k) matrix_swap_rows(LU, k, max_row);
+
+        // Столбец уже нулевой - исключать нечего
+        if (max_val == 0.0) continue;
+
+        const double* row_k = matrix_ptr(LU, k, 0);
+        const double pivot = row_k[k];
+        for (size_t i = k + 1; i < n; ++i) {
+            double* row_i = matrix_ptr(LU, i, 0);
+            double factor = row_i[k] / pivot;
+            row_i[k] = factor;  // Множитель сохраняется на месте L
+            for (size_t j = k + 1; j < n; ++j) {
+                row_i[j] -= factor * row_k[j];
+            }
+        }
+    }
+    return LU;
+}
+
+// Решение A*X = B по готовому LU-разложению (B перезаписывается решением)
+int matrix_lu_solve(const matrix* LU, const size_t* piv, matrix* B) {
+    if (!LU || !piv || !B || LU->w != LU->h || B->h != LU->h)
+        return -1;
+
+    const size_t n = LU->h;
+    const size_t nrhs = B->w;
+
+    // Проверка на вырожденность
+    for (size_t k = 0; k < n; ++k) {
+        if (*matrix_cptr(LU, k, k) == 0.0) return -1;
+    }
+
+    // Применение перестановок строк: B = P*B
+    for (size_t k = 0; k < n; ++k) {
+        if (piv[k] != k) matrix_swap_rows(B, k, piv[k]);
+    }
+
+    // Прямой ход: L*Y = P*B
+    for (size_t i = 1; i < n; ++i) {
+        double* b_i = matrix_ptr(B, i, 0);
+        for (size_t k = 0; k < i; ++k) {
+            const double l = *matrix_cptr(LU, i, k);
+            const double* b_k = matrix_cptr(B, k, 0);
+            for (size_t c = 0; c < nrhs; ++c) b_i[c] -= l * b_k[c];
+        }
+    }
+
+    // Обратный ход: U*X = Y
+    for (size_t i = n; i-- > 0; ) {
+        double* b_i = matrix_ptr(B, i, 0);
+        for (size_t k = i + 1; k < n; ++k) {
+            const double u = *matrix_cptr(LU, i, k);
+            const double* b_k = matrix_cptr(B, k, 0);
+            for (size_t c = 0; c < nrhs; ++c) b_i[c] -= u * b_k[c];
+        }
+        const double d = *matrix_cptr(LU, i, i);
+        for (size_t c = 0; c < nrhs; ++c) b_i[c] /= d;
+    }
+    return 0;
+}
+
+// Решение A^T*x = b по LU-разложению для одного вектора x (на месте)
+static void lu_solve_transposed(const matrix* LU, const size_t* piv, double* x) {
+    const size_t n = LU->h;
+
+    // U^T*w = b
+    for (size_t i = 0; i < n; ++i) {
+        double s = x[i];
+        for (size_t k = 0; k < i; ++k) s -= *matrix_cptr(LU, k, i) * x[k];
+        x[i] = s / *matrix_cptr(LU, i, i);
+    }
+
+    // L^T*v = w
+    for (size_t i = n; i-- > 0; ) {
+        double s = x[i];
+        for (size_t k = i + 1; k < n; ++k) s -= *matrix_cptr(LU, k, i) * x[k];
+        x[i] = s;
+    }
+
+    // x = P^T*v (перестановки в обратном порядке)
+    for (size_t k = n; k-- > 0; ) {
+        if (piv[k] != k) {
+            double tmp = x[k];
+            x[k] = x[piv[k]];
+            x[piv[k]] = tmp;
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT DEFAULT
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+// Сумма модулей элементов вектора
+static double vec_norm_1(const double* x, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; ++i) s += fabs(x[i]);
+    return s;
+}
+
+// Оценка числа обусловленности в 1-норме: ||A||_1 * ||A^-1||_1.
+// ||A^-1||_1 оценивается алгоритмом Хейгера-Хайэма по готовому
+// LU-разложению за O(n^2) операций, без вычисления обратной матрицы.
+// Для вырожденной матрицы возвращается INFINITY, при ошибке -1.
+double matrix_cond_est(const matrix* A, const matrix* LU, const size_t* piv) {
+    if (!A || !LU || !piv || A->w != A->h || LU->w != LU->h || A->h != LU->h)
+        return -1.0;
+
+    const size_t n = A->h;
+    if (n == 0) return 0.0;
+
+    // Нулевой ведущий элемент - матрица вырождена
+    for (size_t k = 0; k < n; ++k) {
+        if (*matrix_cptr(LU, k, k) == 0.0) return INFINITY;
+    }
+
+    double norm_a = matrix_norm_1(A);
+    if (norm_a < 0.0) return -1.0;
+
+    // Векторы-столбцы для решения систем с A
+    matrix* x = matrix_alloc(1, n);
+    double* z = malloc(n * sizeof(double));
+    if (!x || !z) {
+        matrix_free(x);
+        free(z);
+        return -1.0;
+    }
+
+    double est = 0.0;     // Текущая оценка ||A^-1||_1
+    size_t j_prev = n;    // Индекс предыдущего x = e_j (n - равномерный вектор)
+    for (size_t i = 0; i < n; ++i) *matrix_ptr(x, i, 0) = 1.0 / (double)n;
+
+    for (int iter = 0; iter < 5; ++iter) {
+        // y = A^-1 * x (на месте x)
+        matrix_lu_solve(LU, piv, x);
+        const double* y = matrix_cptr(x, 0, 0);
+
+        double est_new = vec_norm_1(y, n);
+        if (iter > 0 && est_new <= est) break;  // Оценка перестала расти
+        est = est_new;
+
+        // z = A^-T * sign(y)
+        for (size_t i = 0; i < n; ++i) z[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+        lu_solve_transposed(LU, piv, z);
+
+        // Поиск компоненты z с максимальным модулем
+        size_t j_max = 0;
+        for (size_t i = 1; i < n; ++i) {
+            if (fabs(z[i]) > fabs(z[j_max])) j_max = i;
+        }
+
+        // Критерий Хейгера: ||z||_inf <= z^T * x - локальный максимум достигнут
+        // (после первого шага проверка не выполняется, как в LAPACK dlacn2)
+        if (j_prev != n && (j_max == j_prev || fabs(z[j_max]) <= z[j_prev])) break;
+
+        // Следующее приближение: x = e_j
+        matrix_set_zero(x);
+        *matrix_ptr(x, j_max, 0) = 1.0;
+        j_prev = j_max;
+    }
+
+    // Дополнительная проверка Хайэма на знакочередующемся векторе
+    // b_i = (-1)^i * (1 + i/(n-1)), защищающая от неудачных случаев
+    for (size_t i = 0; i < n; ++i) {
+        double b = n > 1 ? 1.0 + (double)i / (double)(n - 1) : 1.0;
+        *matrix_ptr(x, i, 0) = (i % 2) ? -b : b;
+    }
+    matrix_lu_solve(LU, piv, x);
+    double alt = 2.0 * vec_norm_1(matrix_cptr(x, 0, 0), n) / (3.0 * (double)n);
+    if (alt > est) est = alt;
+
+    free(z);
+    matrix_free(x);
+    return norm_a * est;
+}
+
+// Степени m ряда Тейлора и соответствующие theta_m для двойной точности
+// (Al-Mohy, Higham, "Computing the action of the matrix exponential", 2011):
+// при ||t*A||_1 / s <= theta_m отрезок ряда степени m дает точность 2^-53
+static const int expm_m[] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 35, 40, 45, 50, 55
+};
+static const double expm_theta[] = {
+    2.29e-16, 2.58e-8, 1.39e-5, 3.40e-4, 2.40e-3, 9.07e-3, 2.38e-2, 5.00e-2, 8.96e-2, 1.44e-1,
+    2.14e-1, 3.00e-1, 4.00e-1, 5.14e-1, 6.41e-1, 7.81e-1, 9.31e-1, 1.09, 1.26, 1.44,
+    1.62, 1.82, 2.01, 2.22, 2.43, 2.64, 2.86, 3.08, 3.31, 3.54, 4.7, 6.0, 7.2, 8.5, 9.9
+};
+
+// Наибольшее число шагов s: при большей ||t*(A - mu*I)||_1 (больше
+// MATRIX_EXPM_MAX_STEPS * 9.9, около 1e6) результат не вычисляется
+#define MATRIX_EXPM_MAX_STEPS 100000
+
+// 1-норма сдвинутой матрицы A - mu*I без ее построения (-1 при ошибке памяти)
+static double shifted_norm_1(const matrix* A, double mu) {
+    const size_t n = A->h;
+    double* col_sum = calloc(n, sizeof(double));
+    if (!col_sum) return n ? -1.0 : 0.0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double* row = matrix_cptr(A, i, 0);
+        for (size_t j = 0; j < n; ++j) {
+            col_sum[j] += fabs(i == j ? row[j] - mu : row[j]);
+        }
+    }
+
+    double max_sum = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        if (col_sum[j] > max_sum) max_sum = col_sum[j];
+    }
+    free(col_sum);
+    return max_sum;
+}
+
+// Вычисление действия матричной экспоненты exp(t*A)*V без построения exp(A).
+// Используется отрезок ряда Тейлора степени m, применяемый s раз к сдвинутой
+// матрице A - mu*I; (m, s) выбираются по 1-норме так, чтобы минимизировать
+// число умножений матрицы на блок векторов V (O(n^2 * p) каждое).
+matrix* matrix_expm_multiply(const matrix* A, const matrix* V, double t, double eps) {
+    // A должна быть квадратной, число строк V совпадать с размером A
+    if (!A || !V || A->w != A->h || V->h != A->h) return NULL;
+
+    const size_t n = A->h;
+    const size_t p = V->w;
+
+    // Сдвиг на среднее диагональных элементов уменьшает норму
+    double mu = 0.0;
+    for (size_t i = 0; i < n; ++i) mu += *matrix_cptr(A, i, i);
+    if (n > 0) mu /= (double)n;
+
+    matrix* F = matrix_copy(V);    // Результат
+    matrix* Bk = matrix_copy(V);   // Текущий член ряда
+    matrix* tmp = matrix_alloc(p, n);
+
+    // Выбор степени m и числа шагов s по ||t*(A - mu*I)||_1.
+    // Отрицательная норма - ошибка выделения памяти, бесконечная или nan -
+    // переполнение или неверные данные, слишком большая требует больше
+    // MATRIX_EXPM_MAX_STEPS шагов: во всех случаях результата нет
+    const size_t nm = sizeof(expm_m) / sizeof(expm_m[0]);
+    double norm_a = shifted_norm_1(A, mu);
+    double norm = fabs(t) * norm_a;
+    if (!F || !Bk || !tmp || norm_a < 0.0 || !isfinite(norm_a) || !isfinite(norm) ||
+        norm > MATRIX_EXPM_MAX_STEPS * expm_theta[nm - 1]) {
+        matrix_free(F);
+        matrix_free(Bk);
+        matrix_free(tmp);
+        return NULL;
+    }
+
+    int m = 0;
+    size_t s = 1;
+    if (norm > 0.0) {
+        double best = INFINITY;
+        for (size_t k = 0; k < nm; ++k) {
+            double sk = ceil(norm / expm_theta[k]);
+            if (sk < 1.0) sk = 1.0;
+            if (expm_m[k] * sk < best) {
+                best = expm_m[k] * sk;
+                m = expm_m[k];
+                s = (size_t)sk;
+            }
+        }
+    }
+
+    const double eta = exp(t * mu / (double)s);  // Множитель сдвига на одном шаге
+    for (size_t step = 0; step < s; ++step) {
+        double c1 = matrix_norm(Bk);
+        for (int k = 1; k <= m; ++k) {
+            // Bk = t/(s*k) * (A*Bk - mu*Bk): сдвиг применяется к произведению
+            matrix_mul2(tmp, A, Bk);
+            for (size_t i = 0; i < n; ++i) {
+                double* row = matrix_ptr(tmp, i, 0);
+                const double* b = matrix_cptr(Bk, i, 0);
+                for (size_t c = 0; c < p; ++c) row[c] -= mu * b[c];
+            }
+            matrix_smul(tmp, t / ((double)s * k));
+            matrix* swap = Bk;
+            Bk = tmp;
+            tmp = swap;
+
+            double c2 = matrix_norm(Bk);
+            matrix_add(F, Bk);
+
+            // Ранний выход: два последних члена пренебрежимо малы
+            if (c1 + c2 <= eps * matrix_norm(F)) break;
+            c1 = c2;
+        }
+        matrix_smul(F, eta);
+        matrix_assign(Bk, F);
+    }
+
+    matrix_free(Bk);
+    matrix_free(tmp);
+    return F;
+}
+
+// Действие экспоненты в нескольких точках времени: out[k] = exp(t[k]*A)*V.
+// Каждая точка получается из предыдущей шагом t[k] - t[k-1], поэтому
+// для упорядоченной сетки суммарная стоимость определяется ее длиной.
+int matrix_expm_multiply_times(const matrix* A, const matrix* V, const double* t, size_t nt,
+                               double eps, matrix** out) {
+    if (!A || !V || !out || (nt > 0 && !t)) return -1;
+
+    const matrix* prev = V;
+    double t_prev = 0.0;
+    for (size_t k = 0; k < nt; ++k) {
+        out[k] = matrix_expm_multiply(A, prev, t[k] - t_prev, eps);
+        if (!out[k]) {
+            // Освобождение уже вычисленных результатов
+            for (size_t i = 0; i < k; ++i) {
+                matrix_free(out[i]);
+                out[i] = NULL;
+            }
+            return -1;
+        }
+        prev = out[k];
+        t_prev = t[k];
+    }
+    return 0;
+}
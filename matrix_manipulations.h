@@ -1,13 +1,24 @@
-#ifndef MATRIX_MANIPULATIONS_H_INCLUDED
-#define MATRIX_MANIPULATIONS_H_INCLUDED
-
-#include "MATRIXES.h"
-
-
-
-//  
-matrix* matrix_exp(const matrix* m, double eps);
-matrix* matrix_solve_gauss(const matrix* A, const matrix* B);
-
-
-#endif // MATRIX_MANIPULATIONS_H_INCLUDED
+#ifndef MATRIX_MANIPULATIONS_H_INCLUDED
+#define MATRIX_MANIPULATIONS_H_INCLUDED
+
+#include "MATRIXES.h"
+
+
+
+// Специальные функции
+matrix* matrix_exp(const matrix* m, double eps);
+matrix* matrix_solve_gauss(const matrix* A, const matrix* B);
+
+// LU-разложение и оценка обусловленности
+matrix* matrix_lu(const matrix* A, size_t* piv);                          // P*A = L*U, L и U в одной матрице
+int matrix_lu_solve(const matrix* LU, const size_t* piv, matrix* B);      // Решение A*X = B (B перезаписывается)
+double matrix_cond_est(const matrix* A, const matrix* LU, const size_t* piv); // Оценка числа обусловленности в 1-норме
+
+// Действие матричной экспоненты на векторы
+// NULL при ошибке, а также если ||t*(A - tr(A)/n*I)||_1 > ~1e6 (слишком много шагов)
+matrix* matrix_expm_multiply(const matrix* A, const matrix* V, double t, double eps); // exp(t*A)*V
+int matrix_expm_multiply_times(const matrix* A, const matrix* V, const double* t, size_t nt,
+                               double eps, matrix** out);                       // out[k] = exp(t[k]*A)*V
+
+
+#endif // MATRIX_MANIPULATIONS_H_INCLUDED
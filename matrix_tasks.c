@@ -0,0 +1,783 @@
+#include "matrix_tasks.h"
+#include "matrix_operations.h"
+#include "matrix_manipulations.h"
+#include <stdlib.h>
+#include <math.h>
+
+// Потоки и синхронизация: Win32 API или POSIX threads
+#ifdef _WIN32
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600    // Условные переменные появились в Windows Vista
+#endif
+#include <windows.h>
+typedef HANDLE mt_thread;
+typedef CRITICAL_SECTION mt_mutex;
+typedef CONDITION_VARIABLE mt_cond;
+#define mt_mutex_init(m)    InitializeCriticalSection(m)
+#define mt_mutex_destroy(m) DeleteCriticalSection(m)
+#define mt_lock(m)          EnterCriticalSection(m)
+#define mt_unlock(m)        LeaveCriticalSection(m)
+#define mt_cond_init(c)     InitializeConditionVariable(c)
+#define mt_cond_destroy(c)  ((void)(c))
+#define mt_wait(c, m)       SleepConditionVariableCS(c, m, INFINITE)
+#define mt_signal(c)        WakeConditionVariable(c)
+#define mt_broadcast(c)     WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t mt_thread;
+typedef pthread_mutex_t mt_mutex;
+typedef pthread_cond_t mt_cond;
+#define mt_mutex_init(m)    pthread_mutex_init(m, NULL)
+#define mt_mutex_destroy(m) pthread_mutex_destroy(m)
+#define mt_lock(m)          pthread_mutex_lock(m)
+#define mt_unlock(m)        pthread_mutex_unlock(m)
+#define mt_cond_init(c)     pthread_cond_init(c, NULL)
+#define mt_cond_destroy(c)  pthread_cond_destroy(c)
+#define mt_wait(c, m)       pthread_cond_wait(c, m)
+#define mt_signal(c)        pthread_cond_signal(c)
+#define mt_broadcast(c)     pthread_cond_broadcast(c)
+#endif
+
+// вариант c
+struct matrix {
+    double* data;   // Данные матрицы
+    size_t w;       // Ширина (количество столбцов)
+    size_t h;       // Высота (количество строк)
+};
+
+#define MATRIX_TASK_BLOCK 64   // Размер блока (строк для умножения, столбцов для LU)
+
+// Узел графа задач
+struct matrix_task {
+    matrix_graph* graph;       // Граф, которому принадлежит задача
+    matrix_task_fn fn;         // Функция задачи
+    void* arg;                 // Аргумент функции
+    int free_arg;              // Освобождать ли arg после выполнения
+    int status;                // Результат выполнения
+    int done;                  // Признак завершения
+    int dep_failed;            // Одна из зависимостей завершилась ошибкой
+    size_t unmet;              // Число незавершенных зависимостей
+    matrix_task** succ;        // Зависящие задачи
+    size_t nsucc;              // Количество зависящих задач
+    size_t cap;                // Емкость массива succ
+    matrix_task* next_ready;   // Следующая задача в очереди готовых
+    matrix_task* next_all;     // Следующая задача в списке всех задач
+};
+
+// Граф задач с пулом потоков
+struct matrix_graph {
+    mt_thread* threads;        // Рабочие потоки
+    size_t nthreads;           // Количество потоков
+    mt_mutex lock;             // Защита всех полей графа и задач
+    mt_cond ready_cv;          // Появилась готовая задача или остановка
+    mt_cond done_cv;           // Завершилась задача
+    matrix_task* ready_head;   // Очередь готовых задач
+    matrix_task* ready_tail;
+    matrix_task* all;          // Все задачи (для освобождения)
+    size_t pending;            // Число незавершенных задач
+    int failed;                // Была ли задача с ошибкой
+    int stop;                  // Признак остановки потоков
+};
+
+// Добавление задачи в очередь готовых (под блокировкой)
+static void push_ready(matrix_graph* g, matrix_task* t) {
+    t->next_ready = NULL;
+    if (g->ready_tail) g->ready_tail->next_ready = t;
+    else g->ready_head = t;
+    g->ready_tail = t;
+    mt_signal(&g->ready_cv);
+}
+
+// Рабочий поток: выполнение готовых задач до остановки графа
+static void worker(matrix_graph* g) {
+    mt_lock(&g->lock);
+    for (;;) {
+        while (!g->ready_head && !g->stop)
+            mt_wait(&g->ready_cv, &g->lock);
+        if (!g->ready_head) break;  // Остановка и очередь пуста
+
+        // Извлечение задачи из очереди
+        matrix_task* t = g->ready_head;
+        g->ready_head = t->next_ready;
+        if (!g->ready_head) g->ready_tail = NULL;
+        mt_unlock(&g->lock);
+
+        // Выполнение вне блокировки
+        int status = t->dep_failed ? -1 : t->fn(t->arg);
+        if (t->free_arg) free(t->arg);
+
+        mt_lock(&g->lock);
+        t->status = status;
+        t->done = 1;
+        if (status != 0) g->failed = 1;
+
+        // Освобождение зависящих задач
+        for (size_t k = 0; k < t->nsucc; ++k) {
+            matrix_task* s = t->succ[k];
+            if (status != 0) s->dep_failed = 1;
+            if (--s->unmet == 0) push_ready(g, s);
+        }
+        free(t->succ);
+        t->succ = NULL;
+        t->nsucc = t->cap = 0;
+
+        --g->pending;
+        mt_broadcast(&g->done_cv);
+    }
+    mt_unlock(&g->lock);
+}
+
+// Запуск, ожидание потоков и число процессоров для каждой платформы
+#ifdef _WIN32
+static DWORD WINAPI worker_entry(LPVOID p) {
+    worker(p);
+    return 0;
+}
+
+static int mt_thread_create(mt_thread* t, matrix_graph* g) {
+    *t = CreateThread(NULL, 0, worker_entry, g, 0, NULL);
+    return *t ? 0 : -1;
+}
+
+static void mt_thread_join(mt_thread t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+
+static size_t mt_ncpu(void) {
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors;
+}
+#else
+static void* worker_entry(void* p) {
+    worker(p);
+    return NULL;
+}
+
+static int mt_thread_create(mt_thread* t, matrix_graph* g) {
+    return pthread_create(t, NULL, worker_entry, g);
+}
+
+static void mt_thread_join(mt_thread t) {
+    pthread_join(t, NULL);
+}
+
+static size_t mt_ncpu(void) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    return ncpu > 0 ? (size_t)ncpu : 0;
+}
+#endif
+
+// Создание графа с пулом потоков
+matrix_graph* matrix_graph_alloc(size_t nthreads) {
+    if (nthreads == 0) nthreads = mt_ncpu();
+    if (nthreads == 0) nthreads = 1;
+
+    matrix_graph* g = calloc(1, sizeof(matrix_graph));
+    if (!g) return NULL;
+
+    g->threads = malloc(nthreads * sizeof(mt_thread));
+    if (!g->threads) {
+        free(g);
+        return NULL;
+    }
+
+    mt_mutex_init(&g->lock);
+    mt_cond_init(&g->ready_cv);
+    mt_cond_init(&g->done_cv);
+
+    // Запуск потоков (при ошибке работаем с уже запущенными)
+    for (size_t i = 0; i < nthreads; ++i) {
+        if (mt_thread_create(&g->threads[i], g) != 0) break;
+        ++g->nthreads;
+    }
+    if (g->nthreads == 0) {
+        matrix_graph_free(g);
+        return NULL;
+    }
+    return g;
+}
+
+// Ожидание завершения всех поставленных задач
+int matrix_graph_wait(matrix_graph* g) {
+    if (!g) return -1;
+
+    mt_lock(&g->lock);
+    while (g->pending > 0)
+        mt_wait(&g->done_cv, &g->lock);
+    int result = g->failed ? -1 : 0;
+    mt_unlock(&g->lock);
+    return result;
+}
+
+// Освобождение графа (после завершения всех задач)
+void matrix_graph_free(matrix_graph* g) {
+    if (!g) return;
+
+    matrix_graph_wait(g);
+
+    // Остановка потоков
+    mt_lock(&g->lock);
+    g->stop = 1;
+    mt_broadcast(&g->ready_cv);
+    mt_unlock(&g->lock);
+    for (size_t i = 0; i < g->nthreads; ++i)
+        mt_thread_join(g->threads[i]);
+
+    // Освобождение задач
+    matrix_task* t = g->all;
+    while (t) {
+        matrix_task* next = t->next_all;
+        free(t);
+        t = next;
+    }
+
+    mt_cond_destroy(&g->done_cv);
+    mt_cond_destroy(&g->ready_cv);
+    mt_mutex_destroy(&g->lock);
+    free(g->threads);
+    free(g);
+}
+
+// Регистрация зависимостей задачи t (под блокировкой). Если для связи
+// не хватило памяти, уже добавленные связи снимаются и возвращается -1:
+// задачу без гарантированного порядка ставить нельзя.
+static int link_deps(matrix_task* t, matrix_task* const* deps, size_t ndeps) {
+    size_t k = 0;
+    for (; k < ndeps; ++k) {
+        matrix_task* d = deps[k];
+        if (!d || d->done) continue;
+
+        // Регистрация t как зависящей задачи d
+        if (d->nsucc == d->cap) {
+            size_t cap = d->cap ? 2 * d->cap : 4;
+            matrix_task** succ = realloc(d->succ, cap * sizeof(matrix_task*));
+            if (!succ) break;
+            d->succ = succ;
+            d->cap = cap;
+        }
+        d->succ[d->nsucc++] = t;
+        ++t->unmet;
+    }
+
+    if (k < ndeps) {
+        // Откат: под блокировкой связи с t - последние элементы succ
+        while (k-- > 0) {
+            matrix_task* d = deps[k];
+            if (!d || d->done) continue;
+            --d->nsucc;
+            --t->unmet;
+        }
+        return -1;
+    }
+
+    for (k = 0; k < ndeps; ++k) {
+        if (deps[k] && deps[k]->done && deps[k]->status != 0) t->dep_failed = 1;
+    }
+    return 0;
+}
+
+// Постановка задачи. При free_arg аргумент освобождается после выполнения
+// (и при ошибке постановки). Задача с hold не запускается до вызова release.
+// Если задан join (еще не запущенная задача), он не запустится раньше новой
+// задачи: связь создается вместе с задачей, поэтому поставленная задача
+// всегда учтена в join.
+static matrix_task* submit_ex(matrix_graph* g, matrix_task_fn fn, void* arg, int free_arg,
+                              int hold, matrix_task* join,
+                              matrix_task* const* deps, size_t ndeps) {
+    if (!g || !fn) {
+        if (free_arg) free(arg);
+        return NULL;
+    }
+
+    matrix_task* t = calloc(1, sizeof(matrix_task));
+    if (t && join) {
+        // Место для связи с join выделяется заранее
+        t->succ = malloc(sizeof(matrix_task*));
+        if (!t->succ) {
+            free(t);
+            t = NULL;
+        }
+        else t->cap = 1;
+    }
+    if (!t) {
+        if (free_arg) free(arg);
+        return NULL;
+    }
+    t->graph = g;
+    t->fn = fn;
+    t->arg = arg;
+    t->free_arg = free_arg;
+
+    mt_lock(&g->lock);
+    if (link_deps(t, deps, ndeps) != 0) {
+        mt_unlock(&g->lock);
+        free(t->succ);
+        free(t);
+        if (free_arg) free(arg);
+        return NULL;
+    }
+    if (join) {
+        t->succ[t->nsucc++] = join;
+        ++join->unmet;
+    }
+    if (hold) ++t->unmet;
+
+    t->next_all = g->all;
+    g->all = t;
+    ++g->pending;
+    if (t->unmet == 0) push_ready(g, t);
+    mt_unlock(&g->lock);
+    return t;
+}
+
+static matrix_task* submit(matrix_graph* g, matrix_task_fn fn, void* arg, int free_arg,
+                           matrix_task* const* deps, size_t ndeps) {
+    return submit_ex(g, fn, arg, free_arg, 0, NULL, deps, ndeps);
+}
+
+// Постановка подзадачи (arg освобождается после выполнения), которую
+// дожидается join - задача сборки текущей порождающей задачи
+static matrix_task* submit_sub(matrix_task* join, matrix_task_fn fn, void* arg,
+                               matrix_task* const* deps, size_t ndeps) {
+    return submit_ex(join->graph, fn, arg, 1, 0, join, deps, ndeps);
+}
+
+// Запуск задачи, поставленной с hold
+static void release(matrix_task* t) {
+    matrix_graph* g = t->graph;
+    mt_lock(&g->lock);
+    if (--t->unmet == 0) push_ready(g, t);
+    mt_unlock(&g->lock);
+}
+
+// Постановка пользовательской задачи
+matrix_task* matrix_graph_submit(matrix_graph* g, matrix_task_fn fn, void* arg,
+                                 matrix_task* const* deps, size_t ndeps) {
+    return submit(g, fn, arg, 0, deps, ndeps);
+}
+
+// Ожидание завершения задачи
+int matrix_task_wait(matrix_task* t) {
+    if (!t) return -1;
+
+    matrix_graph* g = t->graph;
+    mt_lock(&g->lock);
+    while (!t->done)
+        mt_wait(&g->done_cv, &g->lock);
+    int status = t->status;
+    mt_unlock(&g->lock);
+    return status;
+}
+
+// Аргументы матричных задач
+typedef struct {
+    matrix_task* join;         // Задача, ожидающая подзадачи
+    matrix* m;                 // Результат
+    const matrix* m1;          // Первый операнд
+    const matrix* m2;          // Второй операнд
+    size_t r0, r1;             // Диапазон строк (для блочного умножения)
+} binop_arg;
+
+typedef struct {
+    matrix_task* join;         // Задача, ожидающая подзадачи
+    matrix* LU;                // Факторизуемая матрица
+    size_t* piv;               // Перестановки строк
+    size_t k0, k1;             // Столбцы панели
+    size_t j0, j1;             // Столбцы обновляемого блока
+} lu_arg;
+
+typedef struct {
+    matrix** X;                // Куда записать решение (для matrix_solve_gauss)
+    const matrix* A;           // Матрица системы или ее LU-разложение
+    const matrix* B;           // Правая часть (для matrix_solve_gauss)
+    matrix* rhs;               // Правая часть, заменяемая решением
+    const size_t* piv;         // Перестановки LU-разложения
+} solve_arg;
+
+// Задача, которая ничего не делает (точка сборки зависимостей)
+static int task_nop(void* arg) {
+    (void)arg;
+    return 0;
+}
+
+static int task_transpose(void* arg) {
+    matrix_transpose(((binop_arg*)arg)->m);
+    return 0;
+}
+
+static int task_add2(void* arg) {
+    binop_arg* a = arg;
+    return matrix_add2(a->m, a->m1, a->m2);
+}
+
+static int task_sub2(void* arg) {
+    binop_arg* a = arg;
+    return matrix_sub2(a->m, a->m1, a->m2);
+}
+
+// Ядро умножения без слияния в FMA, как в matrix_mul2, иначе
+// поэлементного совпадения с ним не будет
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// Вычисление строк [r0, r1) произведения m = m1 * m2.
+// Порядок суммирования по k совпадает с matrix_mul2, поэтому
+// результат не зависит от разбиения на блоки.
+static int task_mul2_rows(void* arg) {
+    binop_arg* a = arg;
+    const size_t n = a->m1->w;
+    const size_t w = a->m2->w;
+
+    for (size_t i = a->r0; i < a->r1; ++i) {
+        double* c = a->m->data + i * w;
+        const double* a_row = a->m1->data + i * n;
+        for (size_t j = 0; j < w; ++j) c[j] = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+            const double aik = a_row[k];
+            const double* b = a->m2->data + k * w;
+            for (size_t j = 0; j < w; ++j) c[j] += aik * b[j];
+        }
+    }
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT DEFAULT
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+// Выделение аргументов бинарной операции
+static binop_arg* binop_alloc(matrix* m, const matrix* m1, const matrix* m2) {
+    binop_arg* a = malloc(sizeof(binop_arg));
+    if (!a) return NULL;
+    a->join = NULL;
+    a->m = m;
+    a->m1 = m1;
+    a->m2 = m2;
+    a->r0 = a->r1 = 0;
+    return a;
+}
+
+// Постановка бинарной операции одной задачей
+static matrix_task* submit_binop(matrix_graph* g, matrix_task_fn fn, matrix* m,
+                                 const matrix* m1, const matrix* m2,
+                                 matrix_task* const* deps, size_t ndeps) {
+    binop_arg* a = binop_alloc(m, m1, m2);
+    if (!a) return NULL;
+    return submit(g, fn, a, 1, deps, ndeps);
+}
+
+// Асинхронное транспонирование
+matrix_task* matrix_async_transpose(matrix_graph* g, matrix* m,
+                                    matrix_task* const* deps, size_t ndeps) {
+    return submit_binop(g, task_transpose, m, NULL, NULL, deps, ndeps);
+}
+
+// Асинхронное сложение (m = m1 + m2)
+matrix_task* matrix_async_add2(matrix_graph* g, matrix* m, const matrix* m1, const matrix* m2,
+                               matrix_task* const* deps, size_t ndeps) {
+    return submit_binop(g, task_add2, m, m1, m2, deps, ndeps);
+}
+
+// Асинхронное вычитание (m = m1 - m2)
+matrix_task* matrix_async_sub2(matrix_graph* g, matrix* m, const matrix* m1, const matrix* m2,
+                               matrix_task* const* deps, size_t ndeps) {
+    return submit_binop(g, task_sub2, m, m1, m2, deps, ndeps);
+}
+
+// Порождение задач блочного умножения. Выполняется после готовности
+// операндов, поэтому размеры уже окончательные.
+static int task_mul2_spawn(void* arg) {
+    binop_arg* a = arg;
+    matrix* m = a->m;
+    const matrix* m1 = a->m1;
+    const matrix* m2 = a->m2;
+
+    // Совпадающие аргументы требуют временной матрицы - считаем целиком
+    if (!m || !m1 || !m2 || m == m1 || m == m2 || m->h <= MATRIX_TASK_BLOCK)
+        return matrix_mul2(m, m1, m2);
+
+    if (m1->w != m2->h || m->w != m2->w || m->h != m1->h)
+        return -1;
+
+    // Каждый блок при постановке связывается с join; при ошибке join
+    // дождется уже поставленных блоков
+    for (size_t r0 = 0; r0 < m->h; r0 += MATRIX_TASK_BLOCK) {
+        binop_arg* ba = binop_alloc(m, m1, m2);
+        if (!ba) return -1;
+        ba->r0 = r0;
+        ba->r1 = r0 + MATRIX_TASK_BLOCK < m->h ? r0 + MATRIX_TASK_BLOCK : m->h;
+        if (!submit_sub(a->join, task_mul2_rows, ba, NULL, 0)) return -1;
+    }
+    return 0;
+}
+
+// Постановка задачи, порождающей подзадачи: spawn запускается после deps,
+// возвращаемая задача завершается после spawn и всех порожденных ею задач
+static matrix_task* submit_spawn(matrix_graph* g, matrix_task_fn spawn, void* arg,
+                                 matrix_task** arg_join,
+                                 matrix_task* const* deps, size_t ndeps) {
+    matrix_task* driver = submit_ex(g, spawn, arg, 1, 1, NULL, deps, ndeps);
+    if (!driver) return NULL;
+
+    matrix_task* join = submit(g, task_nop, NULL, 0, &driver, 1);
+    *arg_join = join;
+    if (!join) {
+        // Без задачи сборки подзадачи порождать некуда: драйвер только
+        // освобождает аргумент и не считается ошибкой графа
+        driver->fn = task_nop;
+    }
+    release(driver);
+    return join;
+}
+
+// Асинхронное умножение (m = m1 * m2): по задаче на каждый блок строк
+matrix_task* matrix_async_mul2(matrix_graph* g, matrix* m, const matrix* m1, const matrix* m2,
+                               matrix_task* const* deps, size_t ndeps) {
+    binop_arg* a = binop_alloc(m, m1, m2);
+    if (!a) return NULL;
+    return submit_spawn(g, task_mul2_spawn, a, &a->join, deps, ndeps);
+}
+
+// Ядра блочного LU без слияния в FMA (как matrix_lu)
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+// Факторизация панели - столбцов [k0, k1) ниже диагонали.
+// Перестановки строк применяются только к столбцам панели.
+static int task_lu_panel(void* arg) {
+    lu_arg* a = arg;
+    matrix* LU = a->LU;
+    const size_t n = LU->h;
+
+    for (size_t p = a->k0; p < a->k1; ++p) {
+        // Поиск ведущего элемента в столбце p
+        size_t max_row = p;
+        double max_val = fabs(*matrix_ptr(LU, p, p));
+        for (size_t i = p + 1; i < n; ++i) {
+            double val = fabs(*matrix_ptr(LU, i, p));
+            if (val > max_val) {
+                max_val = val;
+                max_row = i;
+            }
+        }
+
+        a->piv[p] = max_row;
+        if (max_row != p) {
+            double* r1 = matrix_ptr(LU, p, 0);
+            double* r2 = matrix_ptr(LU, max_row, 0);
+            for (size_t j = a->k0; j < a->k1; ++j) {
+                double tmp = r1[j];
+                r1[j] = r2[j];
+                r2[j] = tmp;
+            }
+        }
+
+        if (max_val == 0.0) continue;
+
+        const double* row_p = matrix_ptr(LU, p, 0);
+        const double pivot = row_p[p];
+        for (size_t i = p + 1; i < n; ++i) {
+            double* row_i = matrix_ptr(LU, i, 0);
+            double factor = row_i[p] / pivot;
+            row_i[p] = factor;
+            for (size_t j = p + 1; j < a->k1; ++j) {
+                row_i[j] -= factor * row_p[j];
+            }
+        }
+    }
+    return 0;
+}
+
+// Обновление блока столбцов [j0, j1) по готовой панели [k0, k1):
+// перестановки строк, вычисление строк U и вычитание L*U из остатка.
+// Перестановки панели затрагивают только строки ниже текущего шага,
+// поэтому их можно применить сразу; порядок операций для каждого
+// элемента при этом совпадает с matrix_lu.
+static int task_lu_update(void* arg) {
+    lu_arg* a = arg;
+    matrix* LU = a->LU;
+    const size_t n = LU->h;
+
+    for (size_t p = a->k0; p < a->k1; ++p) {
+        if (a->piv[p] == p) continue;
+        double* row_p = matrix_ptr(LU, p, 0);
+        double* row_q = matrix_ptr(LU, a->piv[p], 0);
+        for (size_t j = a->j0; j < a->j1; ++j) {
+            double tmp = row_p[j];
+            row_p[j] = row_q[j];
+            row_q[j] = tmp;
+        }
+    }
+
+    for (size_t p = a->k0; p < a->k1; ++p) {
+        const double* row_p = matrix_ptr(LU, p, 0);
+        if (row_p[p] == 0.0) continue;  // Нулевой столбец - исключения не было
+
+        for (size_t i = p + 1; i < n; ++i) {
+            double* row_i = matrix_ptr(LU, i, 0);
+            const double factor = row_i[p];
+            for (size_t j = a->j0; j < a->j1; ++j) {
+                row_i[j] -= factor * row_p[j];
+            }
+        }
+    }
+    return 0;
+}
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT DEFAULT
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+// Применение перестановок поздних панелей к уже вычисленным столбцам L
+static int task_lu_finish(void* arg) {
+    lu_arg* a = arg;
+    matrix* LU = a->LU;
+    const size_t n = LU->h;
+
+    for (size_t p = MATRIX_TASK_BLOCK; p < n; ++p) {
+        if (a->piv[p] == p) continue;
+        size_t left = p - p % MATRIX_TASK_BLOCK;  // Начало панели строки p
+        double* r1 = matrix_ptr(LU, p, 0);
+        double* r2 = matrix_ptr(LU, a->piv[p], 0);
+        for (size_t j = 0; j < left; ++j) {
+            double tmp = r1[j];
+            r1[j] = r2[j];
+            r2[j] = tmp;
+        }
+    }
+    return 0;
+}
+
+// Постановка задачи блочного LU, которую дожидается join
+static matrix_task* submit_lu(matrix_task* join, matrix_task_fn fn, matrix* LU, size_t* piv,
+                              size_t k0, size_t k1, size_t j0, size_t j1,
+                              matrix_task* const* deps, size_t ndeps) {
+    lu_arg* a = malloc(sizeof(lu_arg));
+    if (!a) return NULL;
+    a->join = NULL;
+    a->LU = LU;
+    a->piv = piv;
+    a->k0 = k0;
+    a->k1 = k1;
+    a->j0 = j0;
+    a->j1 = j1;
+    return submit_sub(join, fn, a, deps, ndeps);
+}
+
+// Порождение графа блочного LU. Панель k зависит только от последнего
+// обновления своего блока столбцов, поэтому факторизация следующей
+// панели идет параллельно с обновлением остальной части матрицы.
+// Все задачи связываются с join при постановке, поэтому при ошибке
+// join дождется уже поставленных и они не будут писать в LU и piv
+// после matrix_task_wait.
+static int task_lu_spawn(void* arg) {
+    lu_arg* a = arg;
+    matrix* LU = a->LU;
+    if (!LU || !a->piv || LU->w != LU->h) return -1;
+
+    const size_t n = LU->h;
+    const size_t nb = (n + MATRIX_TASK_BLOCK - 1) / MATRIX_TASK_BLOCK;
+    if (nb == 0) return 0;
+
+    // Последняя задача, изменявшая каждый блок столбцов
+    matrix_task** last = calloc(nb, sizeof(matrix_task*));
+    if (!last) return -1;
+
+    int result = 0;
+    matrix_task* panel = NULL;  // Последняя поставленная панель
+    for (size_t k = 0; k < nb && result == 0; ++k) {
+        size_t k0 = k * MATRIX_TASK_BLOCK;
+        size_t k1 = k0 + MATRIX_TASK_BLOCK < n ? k0 + MATRIX_TASK_BLOCK : n;
+
+        panel = submit_lu(a->join, task_lu_panel, LU, a->piv, k0, k1, 0, 0, &last[k], 1);
+        if (!panel) {
+            result = -1;
+            break;
+        }
+
+        for (size_t j = k + 1; j < nb; ++j) {
+            size_t j0 = j * MATRIX_TASK_BLOCK;
+            size_t j1 = j0 + MATRIX_TASK_BLOCK < n ? j0 + MATRIX_TASK_BLOCK : n;
+            matrix_task* deps[2] = { panel, last[j] };
+            last[j] = submit_lu(a->join, task_lu_update, LU, a->piv, k0, k1, j0, j1, deps, 2);
+            if (!last[j]) {
+                result = -1;
+                break;
+            }
+        }
+    }
+
+    // Перестановки поздних панелей - после последней панели
+    if (result == 0 && !submit_lu(a->join, task_lu_finish, LU, a->piv, 0, 0, 0, 0, &panel, 1))
+        result = -1;
+
+    free(last);
+    return result;
+}
+
+// Асинхронное блочное LU-разложение на месте (LU содержит A на входе).
+// Результат совпадает с matrix_lu поэлементно.
+matrix_task* matrix_async_lu(matrix_graph* g, matrix* LU, size_t* piv,
+                             matrix_task* const* deps, size_t ndeps) {
+    lu_arg* a = malloc(sizeof(lu_arg));
+    if (!a) return NULL;
+    a->LU = LU;
+    a->piv = piv;
+    a->k0 = a->k1 = a->j0 = a->j1 = 0;
+    return submit_spawn(g, task_lu_spawn, a, &a->join, deps, ndeps);
+}
+
+static int task_lu_solve(void* arg) {
+    solve_arg* a = arg;
+    return matrix_lu_solve(a->A, a->piv, a->rhs);
+}
+
+static int task_solve_gauss(void* arg) {
+    solve_arg* a = arg;
+    *a->X = matrix_solve_gauss(a->A, a->B);
+    return *a->X ? 0 : -1;
+}
+
+// Асинхронное решение A*X = B по LU-разложению (B перезаписывается)
+matrix_task* matrix_async_lu_solve(matrix_graph* g, const matrix* LU, const size_t* piv, matrix* B,
+                                   matrix_task* const* deps, size_t ndeps) {
+    solve_arg* a = malloc(sizeof(solve_arg));
+    if (!a) return NULL;
+    a->X = NULL;
+    a->A = LU;
+    a->B = NULL;
+    a->rhs = B;
+    a->piv = piv;
+    return submit(g, task_lu_solve, a, 1, deps, ndeps);
+}
+
+// Асинхронное решение СЛАУ методом Гаусса (*X получает новую матрицу)
+matrix_task* matrix_async_solve_gauss(matrix_graph* g, matrix** X, const matrix* A, const matrix* B,
+                                      matrix_task* const* deps, size_t ndeps) {
+    if (!X) return NULL;
+    *X = NULL;
+
+    solve_arg* a = malloc(sizeof(solve_arg));
+    if (!a) return NULL;
+    a->X = X;
+    a->A = A;
+    a->B = B;
+    a->rhs = NULL;
+    a->piv = NULL;
+    return submit(g, task_solve_gauss, a, 1, deps, ndeps);
+}
@@ -0,0 +1,47 @@
+#ifndef MATRIX_TASKS_H_INCLUDED
+#define MATRIX_TASKS_H_INCLUDED
+
+#include "MATRIXES.h"
+
+// Задачи выполняются пулом потоков: POSIX threads (сборка и компоновка
+// с -pthread) или Win32 API в Windows (дополнительных библиотек не нужно)
+
+// Граф асинхронных задач над матрицами (неполные типы)
+struct matrix_graph;
+typedef struct matrix_graph matrix_graph;
+struct matrix_task;
+typedef struct matrix_task matrix_task;
+
+// Функция задачи: 0 - успех, иначе ошибка
+typedef int (*matrix_task_fn)(void* arg);
+
+// Создание и уничтожение графа
+matrix_graph* matrix_graph_alloc(size_t nthreads); // Пул из nthreads потоков (0 - по числу ядер)
+void matrix_graph_free(matrix_graph* g);           // Ожидание всех задач и освобождение графа
+int matrix_graph_wait(matrix_graph* g);            // Ожидание всех задач (-1, если какая-то завершилась ошибкой)
+
+// Постановка задач и ожидание результата.
+// deps - массив из ndeps задач, которые должны завершиться раньше (NULL-элементы пропускаются).
+// Если зависимость завершилась ошибкой, задача не выполняется и тоже завершается ошибкой.
+// Дескрипторы задач действительны до уничтожения графа.
+matrix_task* matrix_graph_submit(matrix_graph* g, matrix_task_fn fn, void* arg,
+                                 matrix_task* const* deps, size_t ndeps);
+int matrix_task_wait(matrix_task* t);              // Ожидание задачи, возвращает ее результат
+
+// Асинхронные варианты операций (аргументы должны жить до завершения задачи)
+matrix_task* matrix_async_transpose(matrix_graph* g, matrix* m,
+                                    matrix_task* const* deps, size_t ndeps);
+matrix_task* matrix_async_add2(matrix_graph* g, matrix* m, const matrix* m1, const matrix* m2,
+                               matrix_task* const* deps, size_t ndeps);
+matrix_task* matrix_async_sub2(matrix_graph* g, matrix* m, const matrix* m1, const matrix* m2,
+                               matrix_task* const* deps, size_t ndeps);
+matrix_task* matrix_async_mul2(matrix_graph* g, matrix* m, const matrix* m1, const matrix* m2,
+                               matrix_task* const* deps, size_t ndeps); // По блокам строк
+matrix_task* matrix_async_lu(matrix_graph* g, matrix* LU, size_t* piv,
+                             matrix_task* const* deps, size_t ndeps);   // Блочное LU на месте
+matrix_task* matrix_async_lu_solve(matrix_graph* g, const matrix* LU, const size_t* piv, matrix* B,
+                                   matrix_task* const* deps, size_t ndeps);
+matrix_task* matrix_async_solve_gauss(matrix_graph* g, matrix** X, const matrix* A, const matrix* B,
+                                      matrix_task* const* deps, size_t ndeps);
+
+#endif // MATRIX_TASKS_H_INCLUDED